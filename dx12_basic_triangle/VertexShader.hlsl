@@ -10,12 +10,21 @@ struct Vertex
     float3 color : COLOR;
 };
 
-// 萔obt@
-cbuffer ConstantBuffer : register(b0)
+// `悲Ƃ̒萔B[g萔œnBdraw_list.hDrawConstantsƍ킹邱
+cbuffer DrawConstants : register(b0)
+{
+    uint objectIndex;
+};
+
+// IuWFNgƂ̃f[^Bdraw_list.hObjectDataƍ킹邱
+struct ObjectData
 {
     float4x4 objToProj;
 };
 
+// `揇ɕ񂾃IuWFNgf[^̍\obt@
+StructuredBuffer<ObjectData> objects : register(t0);
+
 // sNZVF[_ւ̏o
 struct V2P
 {
@@ -26,7 +35,7 @@ struct V2P
 V2P main(Vertex input)
 {
     V2P output;
-    output.position = mul(float4(input.position, 1.0f), objToProj);
+    output.position = mul(float4(input.position, 1.0f), objects[objectIndex].objToProj);
     output.color = float4(input.color, 1.0f);
     return output;
 }
@@ -0,0 +1,175 @@
+
+// adapter_selector.cpp
+// fBXvCA_v^̑IBׂ\͂_tĈԗǂA_v^ƁAŎgԑ`@I
+
+#include "./adapter_selector.h"
+
+namespace {
+    // lD3D_FEATURE_LEVELAD3D_SHADER_MODELƓ
+    constexpr uint32_t kFeatureLevel12_0 = 0xc000;
+    constexpr uint32_t kFeatureLevel12_2 = 0xc200;
+    constexpr uint32_t kShaderModel5_0 = 0x50;
+    constexpr uint32_t kShaderModel6_6 = 0x66;
+
+    // _̊lB\tgEFAA_v^̓n[hEFAA_v^KႭȂ
+    constexpr int kSoftwareAdapterScore = 1;
+    constexpr int kHardwareAdapterScore = 2;
+
+    // prfI128MBƂ̓_B@\̓_̍v͂菬Ă
+    constexpr uint64_t kMemoryStepBytes = 128ull * 1024 * 1024;
+    constexpr int kMemoryStepScore = 32;
+    constexpr uint64_t kMaxMemorySteps = 1 << 16;
+
+    bool HasFeatureLevel12_2(const AdapterCapabilities& c)      { return c.featureLevel >= kFeatureLevel12_2; }
+    bool HasShaderModel6_6(const AdapterCapabilities& c)        { return c.shaderModel >= kShaderModel6_6; }
+    bool HasResourceBindingTier3(const AdapterCapabilities& c)  { return c.resourceBindingTier >= 3; }
+    bool HasMeshShader(const AdapterCapabilities& c)            { return c.meshShaderTier >= 1; }
+    bool HasEnhancedBarriers(const AdapterCapabilities& c)      { return c.enhancedBarriers; }
+
+    // @\̓_t̋KB𖞂bonus𑫂
+    struct FeatureScoreRule
+    {
+        const char* name;
+        int bonus;
+        bool (*test)(const AdapterCapabilities& capabilities);
+    };
+
+    // nCubhGPŮœGPUI΂Ȃ悤ɁA_͐prfI̗ʂŌ܂悤ɂĂ
+    // @\̓_̓ʂ؂̃A_v^m̍ɂȂȂ
+    constexpr FeatureScoreRule kFeatureScoreRules[] =
+    {
+        { "FeatureLevel12_2",       8, HasFeatureLevel12_2 },
+        { "ShaderModel6_6",         4, HasShaderModel6_6 },
+        { "ResourceBindingTier3",   4, HasResourceBindingTier3 },
+        { "MeshShader",             8, HasMeshShader },
+        { "EnhancedBarriers",       4, HasEnhancedBarriers },
+    };
+
+    constexpr int MaxFeatureScore()
+    {
+        int total = 0;
+        for (const FeatureScoreRule& rule : kFeatureScoreRules)
+        {
+            total += rule.bonus;
+        }
+        return total;
+    }
+    static_assert(MaxFeatureScore() < kMemoryStepScore, "feature bonuses must not outweigh one memory step");
+
+    // `@ƂɕKvȔ\
+    struct RenderPathRequirements
+    {
+        RenderPath  path;
+        const char* name;
+        uint32_t    minFeatureLevel;
+        uint32_t    minShaderModel;
+        uint32_t    minResourceBindingTier;
+        uint32_t    minMeshShaderTier;
+        bool        enhancedBarriers;
+    };
+
+    // ̂珇ɕׂB`@A\A@\xAVF[_fA\[XoCfBOTierAbVVF[_TierAgoȀ
+    const RenderPathRequirements kRenderPathTable[] =
+    {
+        { RenderPath::VertexShader, "VertexShader", kFeatureLevel12_0, kShaderModel5_0, 1,       0,    false },
+    };
+
+    const RenderPathRequirements* FindRenderPath(RenderPath path)
+    {
+        for (const RenderPathRequirements& requirements : kRenderPathTable)
+        {
+            if (requirements.path == path)
+            {
+                return &requirements;
+            }
+        }
+        return nullptr;
+    }
+}
+
+// A_v^̓_BprfI̗ʂŌ܂A@\͓ʂ̒ł̍ɂȂȂ
+// \tgEFAA_v^͍Œ̐̒lŁAn[hEFAA_v^I΂BgȂA_v^Ȃ畉̒l
+int ScoreAdapter(const AdapterCapabilities& capabilities)
+{
+    // ̃AvKvƂ@\xɑȂ͎̂gȂ
+    if (capabilities.featureLevel < kFeatureLevel12_0)
+    {
+        return -1;
+    }
+
+    // WARPȂǂ͒x̂ŁAɎgA_v^
+    if (capabilities.isSoftware)
+    {
+        return kSoftwareAdapterScore;
+    }
+
+    uint64_t memorySteps = capabilities.dedicatedVideoMemory / kMemoryStepBytes;
+    if (memorySteps > kMaxMemorySteps)
+    {
+        memorySteps = kMaxMemorySteps;
+    }
+
+    int featureScore = 0;
+    for (const FeatureScoreRule& rule : kFeatureScoreRules)
+    {
+        if (rule.test(capabilities))
+        {
+            featureScore += rule.bonus;
+        }
+    }
+
+    return kHardwareAdapterScore + static_cast<int>(memorySteps) * kMemoryStepScore + featureScore;
+}
+
+// ԓ_̍A_v^̃CfbNXԂB_Ȃ̂́Bĝ-1
+int SelectAdapter(const AdapterCapabilities* adapters, size_t adapterCount)
+{
+    int selected = -1;
+    int bestScore = -1;
+    for (size_t i = 0; i < adapterCount; ++i)
+    {
+        int score = ScoreAdapter(adapters[i]);
+        if (score > bestScore)
+        {
+            selected = static_cast<int>(i);
+            bestScore = score;
+        }
+    }
+    return selected;
+}
+
+// `@̃A_v^Ŏg邩
+bool IsRenderPathSupported(RenderPath path, const AdapterCapabilities& capabilities)
+{
+    const RenderPathRequirements* requirements = FindRenderPath(path);
+    if (requirements == nullptr)
+    {
+        return false;
+    }
+
+    return capabilities.featureLevel >= requirements->minFeatureLevel
+        && capabilities.shaderModel >= requirements->minShaderModel
+        && capabilities.resourceBindingTier >= requirements->minResourceBindingTier
+        && capabilities.meshShaderTier >= requirements->minMeshShaderTier
+        && (!requirements->enhancedBarriers || capabilities.enhancedBarriers);
+}
+
+// gԑ`@IԁBRenderPath::Count
+RenderPath SelectRenderPath(const AdapterCapabilities& capabilities)
+{
+    for (const RenderPathRequirements& requirements : kRenderPathTable)
+    {
+        if (IsRenderPathSupported(requirements.path, capabilities))
+        {
+            return requirements.path;
+        }
+    }
+    return RenderPath::Count;
+}
+
+// `@̕\
+const char* RenderPathName(RenderPath path)
+{
+    const RenderPathRequirements* requirements = FindRenderPath(path);
+    return requirements != nullptr ? requirements->name : "Unknown";
+}
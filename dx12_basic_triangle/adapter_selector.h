@@ -0,0 +1,49 @@
+
+// adapter_selector.h
+// fBXvCA_v^̑IBׂ\͂_tĈԗǂA_v^ƁAŎgԑ`@I
+// DirectXɂ͈ˑȂ̂ŁAA_v^ł
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// A_v^̔\́BCheckFeatureSupportȂǂŒׂ
+struct AdapterCapabilities
+{
+	wchar_t		description[128]		= {};
+	uint32_t	vendorId				= 0;
+	uint32_t	deviceId				= 0;
+	uint64_t	dedicatedVideoMemory	= 0;
+	uint64_t	sharedSystemMemory		= 0;
+	bool		isSoftware				= false;	// WARPȂǂ̃\tgEFAA_v^
+
+	uint32_t	featureLevel			= 0;		// D3D_FEATURE_LEVELƓlB0xc000Ȃ12_0
+	uint32_t	shaderModel				= 0;		// D3D_SHADER_MODELƓlB0x65Ȃ6.5
+	uint32_t	resourceBindingTier		= 0;		// D3D12_RESOURCE_BINDING_TIERƓl
+	uint32_t	meshShaderTier			= 0;		// D3D12_MESH_SHADER_TIERƓlB0Ȃ烁bVVF[_
+	bool		enhancedBarriers		= false;	// goAg邩
+};
+
+// `@B̂珇ɕׂBĂ̂͒_VF[_ł̕`悾
+enum class RenderPath : uint8_t
+{
+	VertexShader,		// _VF[_Ɠ̓AZuŕ`
+	Count
+};
+
+// A_v^̓_BprfI̗ʂŌ܂A@\͓ʂ̒ł̍ɂȂȂ
+// \tgEFAA_v^͍Œ̐̒lŁAn[hEFAA_v^I΂BgȂA_v^Ȃ畉̒l
+int ScoreAdapter(const AdapterCapabilities& capabilities);
+
+// ԓ_̍A_v^̃CfbNXԂB_Ȃ̂́Bĝ-1
+int SelectAdapter(const AdapterCapabilities* adapters, size_t adapterCount);
+
+// `@̃A_v^Ŏg邩
+bool IsRenderPathSupported(RenderPath path, const AdapterCapabilities& capabilities);
+
+// gԑ`@IԁBRenderPath::Count
+RenderPath SelectRenderPath(const AdapterCapabilities& capabilities);
+
+// `@̕\
+const char* RenderPathName(RenderPath path);
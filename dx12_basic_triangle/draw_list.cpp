@@ -0,0 +1,109 @@
+
+// draw_list.cpp
+// `惊XgB`悲Ƃ̃f[^W߂ă\[gAGPU֑`ɋlߒ
+
+#include "./draw_list.h"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+// `搔̃mۂĂ
+void DrawList::reserve(size_t drawCount)
+{
+    m_items.reserve(drawCount);
+    m_sortWork.reserve(drawCount);
+    m_objects.reserve(drawCount);
+}
+
+// `SĎ菜Bmۂ͂̂܂
+void DrawList::clear()
+{
+    m_items.clear();
+    m_objects.clear();
+}
+
+// `ǉ
+void DrawList::add(uint32_t pipeline, uint32_t material, const ObjectData& objectData)
+{
+    assert(m_objects.size() < UINT32_MAX);
+
+    DrawItem item;
+    item.sortKey = makeSortKey(pipeline, material);
+    item.sourceIndex = static_cast<uint32_t>(m_objects.size());
+    m_items.push_back(item);
+
+    m_objects.push_back(objectData);
+}
+
+// \[gL[ɕבւ(\[g)
+void DrawList::sort()
+{
+    const size_t count = m_items.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    // 8bit8pXLSD\[gBqXgO1̑őSpX
+    constexpr int kPassCount = 8;
+    constexpr int kRadix = 256;
+    uint32_t histograms[kPassCount][kRadix] = {};
+    for (const DrawItem& item : m_items)
+    {
+        for (int pass = 0; pass < kPassCount; ++pass)
+        {
+            histograms[pass][(item.sortKey >> (pass * 8)) & 0xff]++;
+        }
+    }
+
+    m_sortWork.resize(count);
+    DrawItem* src = m_items.data();
+    DrawItem* dst = m_sortWork.data();
+
+    for (int pass = 0; pass < kPassCount; ++pass)
+    {
+        const int shift = pass * 8;
+        uint32_t* histogram = histograms[pass];
+
+        // Svf̌œlȂבւKv͂ȂBpCvC}eA̐ȂƂقƂǂ̃pX΂
+        if (histogram[(src[0].sortKey >> shift) & 0xff] == count)
+        {
+            continue;
+        }
+
+        // qXgOݐ̊Jnʒuɕϊ
+        uint32_t offset = 0;
+        for (int i = 0; i < kRadix; ++i)
+        {
+            uint32_t n = histogram[i];
+            histogram[i] = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].sortKey >> shift) & 0xff]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    // ʂƗpobt@ɎcĂւ
+    if (src != m_items.data())
+    {
+        m_items.swap(m_sortWork);
+    }
+}
+
+// IuWFNgf[^`揇ɋl߂ďށB݌iԖڂ̕`objectIndexiɂȂ
+// destCapacity𒴂镪͏܂ȂB߂l͏񂾐ŁA`悷̂͂̐܂
+size_t DrawList::pack(ObjectData* dest, size_t destCapacity) const
+{
+    const size_t count = m_items.size() < destCapacity ? m_items.size() : destCapacity;
+    for (size_t i = 0; i < count; ++i)
+    {
+        memcpy(&dest[i], &m_objects[m_items[i].sourceIndex], sizeof(ObjectData));
+    }
+    return count;
+}
@@ -0,0 +1,61 @@
+
+// draw_list.h
+// `惊XgB`悲Ƃ̃f[^W߂ă\[gAGPU֑`ɋlߒ
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// [g萔œn`悲Ƃ̃f[^BVertexShader.hlslDrawConstantsƍ킹邱
+struct DrawConstants
+{
+	uint32_t objectIndex;		// IuWFNgf[^̍\obt@̃CfbNX
+};
+
+// \obt@ɕׂIuWFNgƂ̃f[^BVertexShader.hlslObjectDataƍ킹邱
+// DirectXMathɈˑȂ悤ɁAsfloat̔zŎBDirectX::XMFLOAT4X4Ɠ
+struct ObjectData
+{
+	float objToProj[4][4];		// ]uς݂̃IuWFNgˉeϊs
+};
+static_assert(sizeof(ObjectData) == 64, "ObjectData must match the HLSL layout");
+
+// 1񕪂̕`
+struct DrawItem
+{
+	uint64_t sortKey;			// 32bitpCvCA32bit}eA
+	uint32_t sourceIndex;		// ǉꂽԂł̃IuWFNgf[^̃CfbNX
+};
+
+// `惊Xg
+class DrawList
+{
+public:
+	// pCvCƃ}eA\[gL[BpCvC̐؂ւԏd̂ŏʂɒu
+	static uint64_t makeSortKey(uint32_t pipeline, uint32_t material) { return (static_cast<uint64_t>(pipeline) << 32) | material; }
+	static uint32_t pipelineFromKey(uint64_t sortKey) { return static_cast<uint32_t>(sortKey >> 32); }
+	static uint32_t materialFromKey(uint64_t sortKey) { return static_cast<uint32_t>(sortKey); }
+
+	void reserve(size_t drawCount);		// `搔̃mۂĂ
+	void clear();						// `SĎ菜Bmۂ͂̂܂
+
+	// `ǉ
+	void add(uint32_t pipeline, uint32_t material, const ObjectData& objectData);
+
+	// \[gL[ɕבւ(\[g)
+	void sort();
+
+	// IuWFNgf[^`揇ɋl߂ďށB݌iԖڂ̕`objectIndexiɂȂ
+	// destCapacity𒴂镪͏܂ȂB߂l͏񂾐ŁA`悷̂͂̐܂
+	size_t pack(ObjectData* dest, size_t destCapacity) const;
+
+	size_t size() const { return m_items.size(); }
+	const DrawItem& operator[](size_t i) const { return m_items[i]; }
+
+private:
+	std::vector<DrawItem>	m_items;
+	std::vector<DrawItem>	m_sortWork;
+	std::vector<ObjectData>	m_objects;
+};
@@ -6,6 +6,7 @@
 
 #include <windows.h>
 #include <cassert>
+#include <cstdio>
 #include <fstream>
 #include <vector>
 
@@ -52,6 +53,105 @@ namespace {
 
         return S_OK;
     }
+
+    // A_v^̔\͂𒲂ׂBD3D12̃foCXȂfalseBfoCX͂̂܂܎g悤ɕԂ
+    bool ProbeAdapter(IDXGIAdapter3* adapter, AdapterCapabilities* capabilities, ID3D12Device** device)
+    {
+        DXGI_ADAPTER_DESC1 adapterDesc = {};
+        HRESULT hr = adapter->GetDesc1(&adapterDesc);
+        assert(hr == S_OK);
+
+        wcscpy_s(capabilities->description, adapterDesc.Description);
+        capabilities->vendorId = adapterDesc.VendorId;
+        capabilities->deviceId = adapterDesc.DeviceId;
+        capabilities->dedicatedVideoMemory = adapterDesc.DedicatedVideoMemory;
+        capabilities->sharedSystemMemory = adapterDesc.SharedSystemMemory;
+        capabilities->isSoftware = (adapterDesc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+
+        hr = D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(device));
+        if (FAILED(hr))
+        {
+            return false;
+        }
+
+        // @\xBÂ^C12_2m炸ɎŝŁA12_2O12_1玎
+        // łsAfoCXꂽ12_0Ƃ
+        const D3D_FEATURE_LEVEL featureLevels[] = { D3D_FEATURE_LEVEL_12_2, D3D_FEATURE_LEVEL_12_1, D3D_FEATURE_LEVEL_12_0 };
+        capabilities->featureLevel = D3D_FEATURE_LEVEL_12_0;
+        for (UINT first = 0; first < _countof(featureLevels) - 1; ++first)
+        {
+            D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevelData = {};
+            featureLevelData.NumFeatureLevels = _countof(featureLevels) - first;
+            featureLevelData.pFeatureLevelsRequested = &featureLevels[first];
+            if (SUCCEEDED((*device)->CheckFeatureSupport(D3D12_FEATURE_FEATURE_LEVELS, &featureLevelData, sizeof(featureLevelData))))
+            {
+                capabilities->featureLevel = featureLevelData.MaxSupportedFeatureLevel;
+                break;
+            }
+        }
+
+        // VF[_fB^CmȂlnƎŝō珇Ɏ
+        const D3D_SHADER_MODEL shaderModels[] =
+        {
+            D3D_SHADER_MODEL_6_7, D3D_SHADER_MODEL_6_6, D3D_SHADER_MODEL_6_5, D3D_SHADER_MODEL_6_4,
+            D3D_SHADER_MODEL_6_3, D3D_SHADER_MODEL_6_2, D3D_SHADER_MODEL_6_1, D3D_SHADER_MODEL_6_0,
+            D3D_SHADER_MODEL_5_1,
+        };
+        for (D3D_SHADER_MODEL shaderModel : shaderModels)
+        {
+            D3D12_FEATURE_DATA_SHADER_MODEL shaderModelData = { shaderModel };
+            if (SUCCEEDED((*device)->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModelData, sizeof(shaderModelData))))
+            {
+                capabilities->shaderModel = shaderModelData.HighestShaderModel;
+                break;
+            }
+        }
+
+        // \[XoCfBOTier
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        hr = (*device)->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options));
+        assert(hr == S_OK);
+        capabilities->resourceBindingTier = options.ResourceBindingTier;
+
+        // bVVF[_BΉĂȂ^Cł͎ŝŁA͎̎gȂ
+        D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7 = {};
+        if (SUCCEEDED((*device)->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS7, &options7, sizeof(options7))))
+        {
+            capabilities->meshShaderTier = options7.MeshShaderTier;
+        }
+
+        // goABΉĂȂ^Cł͎s
+        D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 = {};
+        if (SUCCEEDED((*device)->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12))))
+        {
+            capabilities->enhancedBarriers = options12.EnhancedBarriersSupported != FALSE;
+        }
+
+        return true;
+    }
+
+    // D3D12̃foCXŃ\[X̃𒲂ׂ
+    class D3D12ResourceMemoryQuery : public ResourceMemoryQuery
+    {
+    public:
+        explicit D3D12ResourceMemoryQuery(ID3D12Device* device) : m_device(device) {}
+
+        void queryResource(const void* resource, uint64_t* sizeInBytes, uint32_t* heapType) const override
+        {
+            ID3D12Resource* d3dResource = static_cast<ID3D12Resource*>(const_cast<void*>(resource));
+
+            // ۂɊmۂTCY̓ACg݂̃TCY
+            D3D12_RESOURCE_DESC resourceDesc = d3dResource->GetDesc();
+            *sizeInBytes = m_device->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes;
+
+            // q[vvpeBȂ\[X0ԂăftHgq[vɂ
+            D3D12_HEAP_PROPERTIES heapProperties = {};
+            *heapType = SUCCEEDED(d3dResource->GetHeapProperties(&heapProperties, nullptr)) ? static_cast<uint32_t>(heapProperties.Type) : 0;
+        }
+
+    private:
+        ID3D12Device* m_device;
+    };
 }
 
 // AvP[V̏BN1xĂ
@@ -98,6 +198,13 @@ void Dx12BasicTriangle::init(HWND hWnd)
 
     // J͌_ŒƂĂ̂ŎOp`+Zɏꏊɒu
     m_triangleTrans = DirectX::XMVectorSet(0.0f, 0.0f, 2.5f, 1.0f);
+
+    updateMemoryBudget();
+
+#ifdef DX12_MEMORY_SNAPSHOT
+    // ÑgpʂoĂBsƂɔrł
+    m_memoryTracker.writeSnapshot("memory_snapshot_init.txt");
+#endif
 }
 
 // DirectX 12̏
@@ -106,13 +213,58 @@ void Dx12BasicTriangle::initDirectX12()
     HRESULT hr = CreateDXGIFactory(IID_PPV_ARGS(&m_dxgiFactory));
     assert(hr == S_OK);
 
-    // ͍ŏɌfBXvCA_v^gB{͕XybNČ߂肵ȂƂȂȂ
-    IDXGIAdapter1* adapter = nullptr;
-    hr = m_dxgiFactory->EnumAdapters1(0, &adapter);
-    assert(hr == S_OK);
+    // \Ȃ̂珇ɃA_v^񋓂āAD3D12̃foCX̂̔\͂𒲂ׂ
+    // nCubhGPŮł͗񋓏ƓGPUI΂邱Ƃ̂ŁAׂ\͂_tđI
+    std::vector<IDXGIAdapter3*> adapters;
+    std::vector<ID3D12Device*> devices;
+    std::vector<AdapterCapabilities> capabilities;
 
-    hr = D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&m_device));
-    assert(hr == S_OK);
+    IDXGIAdapter3* adapter = nullptr;
+    for (UINT i = 0; SUCCEEDED(m_dxgiFactory->EnumAdapterByGpuPreference(i, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, IID_PPV_ARGS(&adapter))); ++i)
+    {
+        AdapterCapabilities adapterCapabilities;
+        ID3D12Device* device = nullptr;
+        if (!ProbeAdapter(adapter, &adapterCapabilities, &device))
+        {
+            adapter->Release();
+            continue;
+        }
+
+        adapters.push_back(adapter);
+        devices.push_back(device);
+        capabilities.push_back(adapterCapabilities);
+    }
+
+    // \tgEFAA_v^ɓ̂ŁAIׂȂ̂D3D12̃foCX1Ȃ
+    int selected = SelectAdapter(capabilities.data(), capabilities.size());
+    if (selected < 0)
+    {
+        OutputDebugStringW(L"No adapter supports Direct3D 12 feature level 12_0\n");
+        FatalAppExitW(0, L"No adapter supports Direct3D 12 feature level 12_0");
+        return;
+    }
+
+    // I񂾃A_v^ׂ͒鎞ɍfoCX̂܂܎gAȊO͉
+    for (int i = 0; i < static_cast<int>(adapters.size()); ++i)
+    {
+        if (i != selected)
+        {
+            devices[i]->Release();
+            adapters[i]->Release();
+        }
+    }
+    m_adapter = adapters[selected];
+    m_device = devices[selected];
+    m_adapterCapabilities = capabilities[selected];
+
+    // ̃A_v^Ŏg`@IԁBĂ̂͒_VF[_ł̕`悾Ȃ̂ŁAOɏo߂̏
+    m_renderPath = SelectRenderPath(m_adapterCapabilities);
+    assert(m_renderPath == RenderPath::VertexShader);
+
+    wchar_t message[256];
+    swprintf_s(message, L"Adapter: %s (score %d), render path: %S\n",
+        m_adapterCapabilities.description, ScoreAdapter(m_adapterCapabilities), RenderPathName(m_renderPath));
+    OutputDebugStringW(message);
 }
 
 // R}hL[̍쐬
@@ -162,6 +314,8 @@ void Dx12BasicTriangle::initSwapChain(HWND hWnd)
     {
         hr = m_swapChain->GetBuffer(i, IID_PPV_ARGS(&m_renderTargets[i]));
         assert(hr == S_OK);
+
+        trackResource(m_renderTargets[i], MemoryCategory::RenderTarget, "SwapChainBuffer", __FUNCTION__);
     }
 
     // _[^[Qbgr[̍쐬
@@ -180,6 +334,10 @@ void Dx12BasicTriangle::initSwapChain(HWND hWnd)
         m_device->CreateRenderTargetView(m_renderTargets[i], nullptr, rtvHandle);
         rtvHandle.ptr += m_rtvDescriptorSize;
     }
+
+    // VF[_猩ȂfXNv^q[vCPUȂ̂ŁAfXNv^̃TCY~ŋL^
+    m_memoryTracker.track(m_rtvHeap, MemoryCategory::DescriptorHeap, MemoryHeap::System,
+        static_cast<uint64_t>(m_rtvDescriptorSize) * rtvHeapDesc.NumDescriptors, "RtvHeap", __FUNCTION__);
 }
 
 // tFX̍쐬
@@ -240,6 +398,8 @@ void Dx12BasicTriangle::initVertexBuffer()
     );
     assert(hr == S_OK);
 
+    trackResource(m_vertexBuffer, MemoryCategory::Geometry, "VertexBuffer", __FUNCTION__);
+
     // _f[^Rs[
     void* pVertexDataBegin;
     hr = m_vertexBuffer->Map(0, nullptr, &pVertexDataBegin);
@@ -258,16 +418,23 @@ void Dx12BasicTriangle::initVertexBuffer()
 // VF[_̍쐬
 void Dx12BasicTriangle::initShaders()
 {
-    // [gp[^̐ݒB_VF[_pɒ萔obt@1悤ɂ
-    D3D12_ROOT_PARAMETER rootParameters[1];
-    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-    rootParameters[0].Descriptor.RegisterSpace = 0;
-    rootParameters[0].Descriptor.ShaderRegister = 0;
+    // [gp[^̐ݒB_VF[_pɕ`悲Ƃ̃[g萔ƁAIuWFNgf[^̍\obt@悤ɂ
+    // `悲Ƃɕς̂̓[g萔̃CfbNXȂ̂ŁAIuWFNgĂ萔obt@̍XVCBV̐ݒ肵͗vȂ
+    D3D12_ROOT_PARAMETER rootParameters[2];
+    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParameters[0].Constants.RegisterSpace = 0;
+    rootParameters[0].Constants.ShaderRegister = 0;
+    rootParameters[0].Constants.Num32BitValues = sizeof(DrawConstants) / sizeof(UINT);
     rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 
-    // p[^1̃[gVOl`ɐݒ
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+    rootParameters[1].Descriptor.RegisterSpace = 0;
+    rootParameters[1].Descriptor.ShaderRegister = 0;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+    // p[^2̃[gVOl`ɐݒ
     D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
-    rootSignatureDesc.NumParameters = 1;
+    rootSignatureDesc.NumParameters = _countof(rootParameters);
     rootSignatureDesc.pParameters = rootParameters;
     rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
@@ -281,11 +448,11 @@ void Dx12BasicTriangle::initShaders()
     assert(hr == S_OK);
     signature->Release();
 
-    // 萔obt@p\[X̍쐬
+    // IuWFNgf[^̍\obt@p\[X̍쐬
     D3D12_HEAP_PROPERTIES heapProperties = {};
     heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
 
-    UINT bufferSize = sizeof(DirectX::XMFLOAT4X4);
+    UINT bufferSize = sizeof(ObjectData) * kMaxObjects;
 
     D3D12_RESOURCE_DESC resourceDesc = {};
     resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
@@ -305,9 +472,13 @@ void Dx12BasicTriangle::initShaders()
         &resourceDesc,
         D3D12_RESOURCE_STATE_GENERIC_READ,
         nullptr,
-        IID_PPV_ARGS(&m_constantBuffer));
+        IID_PPV_ARGS(&m_objectBuffer));
     assert(hr == S_OK);
 
+    trackResource(m_objectBuffer, MemoryCategory::ObjectData, "ObjectBuffer", __FUNCTION__);
+
+    m_drawList.reserve(kMaxObjects);
+
     // VF[_oCit@Cǂݍ
 #ifdef _DEBUG
     constexpr wchar_t vertexShaderName[] = L"VertexShader_debug.cso";
@@ -322,6 +493,10 @@ void Dx12BasicTriangle::initShaders()
 
     hr = LoadShader(pixelShaderName, &m_pixelShaderBlob);
     assert(hr == S_OK);
+
+    // VF[_oCiCPUƂċL^
+    m_memoryTracker.track(m_vertexShaderBlob, MemoryCategory::ShaderBytecode, MemoryHeap::System, m_vertexShaderBlob->GetBufferSize(), "VertexShader", __FUNCTION__);
+    m_memoryTracker.track(m_pixelShaderBlob, MemoryCategory::ShaderBytecode, MemoryHeap::System, m_pixelShaderBlob->GetBufferSize(), "PixelShader", __FUNCTION__);
 }
 
 // pCvCXe[g̍쐬
@@ -411,9 +586,45 @@ void Dx12BasicTriangle::initPipelineState()
     assert(hr == S_OK);
 }
 
+// \[X̃gpʂL^
+void Dx12BasicTriangle::trackResource(ID3D12Resource* resource, MemoryCategory category, const char* name, const char* site)
+{
+    D3D12ResourceMemoryQuery query(m_device);
+    bool tracked = m_memoryTracker.trackResource(query, resource, category, name, site);
+    assert(tracked);
+}
+
+// A_v^烁oWFbg擾
+void Dx12BasicTriangle::updateMemoryBudget()
+{
+    const DXGI_MEMORY_SEGMENT_GROUP segmentGroups[] = { DXGI_MEMORY_SEGMENT_GROUP_LOCAL, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL };
+    for (UINT i = 0; i < _countof(segmentGroups); ++i)
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO memoryInfo = {};
+        HRESULT hr = m_adapter->QueryVideoMemoryInfo(0, segmentGroups[i], &memoryInfo);
+        assert(hr == S_OK);
+
+        MemorySegment segment = static_cast<MemorySegment>(i);
+        bool wasOverBudget = m_memoryTracker.isOverBudget(segment);
+        m_memoryTracker.setBudget(segment, memoryInfo.Budget, memoryInfo.CurrentUsage);
+
+        // oWFbg𒴂OSɃ炳ꂽ肷̂ŁAuԂm点
+        if (!wasOverBudget && m_memoryTracker.isOverBudget(segment))
+        {
+            char message[128];
+            sprintf_s(message, "Memory budget exceeded (%s): usage %llu / budget %llu\n",
+                segment == MemorySegment::Local ? "Local" : "NonLocal", memoryInfo.CurrentUsage, memoryInfo.Budget);
+            OutputDebugStringA(message);
+        }
+    }
+}
+
 // V[̍XV
 void Dx12BasicTriangle::update(UINT64 frameNumber, float deltaTime)
 {
+    // oWFbgOS̏󋵂ŕς̂Ŗt[擾
+    updateMemoryBudget();
+
     // 4b1]悤ɉ
     m_triangleRot = DirectX::XMQuaternionMultiply(
         DirectX::XMQuaternionRotationRollPitchYaw(0.0f, 0.5f * DirectX::XM_PI * deltaTime, 0.0f),
@@ -457,13 +668,12 @@ void Dx12BasicTriangle::draw(UINT64 frameNumber)
     m_commandList->RSSetViewports(1, &m_viewport);
     m_commandList->RSSetScissorRects(1, &m_scissorRect);
 
-    // pCvCXe[gݒ
-    m_commandList->SetPipelineState(m_pipelineState);
-
-    // 萔obt@ݒ
-    m_commandList->SetGraphicsRootSignature(m_rootSignature);
-    m_commandList->SetGraphicsRootConstantBufferView(0, m_constantBuffer->GetGPUVirtualAddress());
+    // `惊XgB̓pCvCƃ}eA1ނ
+    constexpr UINT32 kPipelineBasic = 0;
+    constexpr UINT32 kMaterialVertexColor = 0;
+    ID3D12PipelineState* pipelineStates[] = { m_pipelineState };
 
+    m_drawList.clear();
     {
         DirectX::XMMATRIX rot = DirectX::XMMatrixRotationQuaternion(m_triangleRot);
         DirectX::XMMATRIX trans = DirectX::XMMatrixTranslationFromVector(m_triangleTrans);
@@ -471,23 +681,56 @@ void Dx12BasicTriangle::draw(UINT64 frameNumber)
         DirectX::XMFLOAT4X4 objToProj;
         DirectX::XMStoreFloat4x4(&objToProj, DirectX::XMMatrixTranspose(rot * trans * m_proj));
 
-        UINT8* pConstantBufferBegin;
-        HRESULT hr = m_constantBuffer->Map(0, nullptr, reinterpret_cast<void**>(&pConstantBufferBegin));
+        ObjectData objectData;
+        static_assert(sizeof(objectData.objToProj) == sizeof(objToProj), "ObjectData::objToProj must match XMFLOAT4X4");
+        memcpy(objectData.objToProj, &objToProj, sizeof(objToProj));
+
+        m_drawList.add(kPipelineBasic, kMaterialVertexColor, objectData);
+    }
+
+    // Xe[g̐؂ւȂȂ悤ɕבւĂAIuWFNgf[^`揇ɍ\obt@֏
+    // \obt@kMaxObjects̂ŁAꂽ`͎̂Ă
+    m_drawList.sort();
+    size_t drawCount = 0;
+    {
+        ObjectData* pObjectBufferBegin;
+        HRESULT hr = m_objectBuffer->Map(0, nullptr, reinterpret_cast<void**>(&pObjectBufferBegin));
         assert(hr == S_OK);
 
-        memcpy(pConstantBufferBegin, &objToProj, sizeof(objToProj));
+        drawCount = m_drawList.pack(pObjectBufferBegin, kMaxObjects);
+        assert(drawCount == m_drawList.size());
 
-        m_constantBuffer->Unmap(0, nullptr);
+        m_objectBuffer->Unmap(0, nullptr);
     }
 
+    // [gVOl`ƍ\obt@ݒ
+    m_commandList->SetGraphicsRootSignature(m_rootSignature);
+    m_commandList->SetGraphicsRootShaderResourceView(1, m_objectBuffer->GetGPUVirtualAddress());
+
     // `悷`͎Op`Xg
     m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     // _obt@ݒ
     m_commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
 
-    // 3_`
-    m_commandList->DrawInstanced(3, 1, 0, 0);
+    // `惊Xg̏3_`BpCvCXe[g͕ςݒ肵
+    UINT32 currentPipeline = UINT32_MAX;
+    for (size_t i = 0; i < drawCount; ++i)
+    {
+        UINT32 pipeline = DrawList::pipelineFromKey(m_drawList[i].sortKey);
+        if (pipeline != currentPipeline)
+        {
+            m_commandList->SetPipelineState(pipelineStates[pipeline]);
+            currentPipeline = pipeline;
+        }
+
+        // `悲Ƃɕς̂̓[g萔̃IuWFNg̃CfbNX
+        DrawConstants drawConstants;
+        drawConstants.objectIndex = static_cast<UINT32>(i);
+        m_commandList->SetGraphicsRoot32BitConstants(0, sizeof(DrawConstants) / sizeof(UINT), &drawConstants, 0);
+
+        m_commandList->DrawInstanced(3, 1, 0, 0);
+    }
 
     // _[^[QbggpsɂoA
     D3D12_RESOURCE_BARRIER barrierRtToPresent = {};
@@ -525,13 +768,13 @@ void Dx12BasicTriangle::draw(UINT64 frameNumber)
 // AvP[V̏I
 void Dx12BasicTriangle::finalize()
 {
-    auto safeRelease = [](auto& p) { if (p != nullptr) { p->Release(); p = nullptr; } };
+    auto safeRelease = [this](auto& p) { if (p != nullptr) { m_memoryTracker.untrack(p); p->Release(); p = nullptr; } };
 
     safeRelease(m_pipelineState);
 
     safeRelease(m_vertexShaderBlob);
     safeRelease(m_pixelShaderBlob);
-    safeRelease(m_constantBuffer);
+    safeRelease(m_objectBuffer);
     safeRelease(m_rootSignature);
 
     safeRelease(m_vertexBuffer);
@@ -550,6 +793,10 @@ void Dx12BasicTriangle::finalize()
     safeRelease(m_commandAllocator);
     safeRelease(m_commandQueue);
 
+    // L^̂͑SĉĂ͂
+    assert(m_memoryTracker.allocationCount() == 0);
+
     safeRelease(m_device);
+    safeRelease(m_adapter);
     safeRelease(m_dxgiFactory);
 }
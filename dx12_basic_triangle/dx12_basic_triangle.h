@@ -9,6 +9,10 @@
 #include <dxgi1_6.h>
 #include <DirectXMath.h>
 
+#include "./adapter_selector.h"
+#include "./draw_list.h"
+#include "./memory_tracker.h"
+
 // AvP[V{
 class Dx12BasicTriangle
 {
@@ -20,11 +24,17 @@ public:
 	// Xbv`FCobt@̌
 	static constexpr int kBufferCount = 2;
 
+	// 1t[ɕ`łIuWFNg̍ő吔
+	static constexpr int kMaxObjects = 1024;
+
 	void init(HWND hWnd);								// AvP[V̏BN1xĂ
 	void update(UINT64 frameNumber, float deltaTime);	// V[̍XV
 	void draw(UINT64 frameNumber);						// V[̕`揈
 	void finalize();									// AvP[V̏I
 
+	const AdapterCapabilities& adapterCapabilities() const { return m_adapterCapabilities; }	// gp̃A_v^̔\
+	RenderPath renderPath() const { return m_renderPath; }									// gp̕`@
+
 protected:
 	void initDirectX12();				// DirectX 12̏
 	void initCommandQueue();			// R}hL[̍쐬
@@ -34,10 +44,19 @@ protected:
 	void initShaders();					// VF[_̍쐬
 	void initPipelineState();			// pCvCXe[g̍쐬
 
+	void trackResource(ID3D12Resource* resource, MemoryCategory category, const char* name, const char* site);	// \[X̃gpʂL^
+	void updateMemoryBudget();			// A_v^烁oWFbg擾
+
 private:
 	IDXGIFactory6*				m_dxgiFactory		= nullptr;
+	IDXGIAdapter3*				m_adapter			= nullptr;
 	ID3D12Device*				m_device			= nullptr;
 
+	AdapterCapabilities			m_adapterCapabilities;
+	RenderPath					m_renderPath		= RenderPath::Count;
+
+	MemoryTracker				m_memoryTracker;
+
 	ID3D12CommandQueue*			m_commandQueue		= nullptr;
 	ID3D12CommandAllocator*		m_commandAllocator	= nullptr;
 	ID3D12GraphicsCommandList*	m_commandList		= nullptr;
@@ -54,7 +73,7 @@ private:
 	D3D12_VERTEX_BUFFER_VIEW	m_vertexBufferView	= {};
 
 	ID3D12RootSignature*		m_rootSignature			= nullptr;
-	ID3D12Resource*				m_constantBuffer		= nullptr;
+	ID3D12Resource*				m_objectBuffer			= nullptr;
 	ID3DBlob*					m_vertexShaderBlob		= nullptr;
 	ID3DBlob*					m_pixelShaderBlob		= nullptr;
 
@@ -63,6 +82,8 @@ private:
 	D3D12_VIEWPORT				m_viewport			= {};
 	D3D12_RECT					m_scissorRect		= {};
 
+	DrawList					m_drawList;
+
 	DirectX::XMMATRIX			m_proj				= DirectX::XMMatrixIdentity();
 	DirectX::XMVECTOR			m_triangleTrans		= DirectX::XMVectorZero();
 	DirectX::XMVECTOR			m_triangleRot		= DirectX::XMQuaternionIdentity();
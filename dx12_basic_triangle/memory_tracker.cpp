@@ -0,0 +1,267 @@
+
+// memory_tracker.cpp
+// gpʂ̋L^Bmۂ\[XނƂɐāAől⃁oWFbgƈꏏɌ悤ɂ
+
+#include "./memory_tracker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// ݒl𑝂₵AőlXV
+void MemoryTracker::Counter::add(uint64_t size)
+{
+    uint64_t value = current.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t prevPeak = peak.load(std::memory_order_relaxed);
+    while (prevPeak < value && !peak.compare_exchange_weak(prevPeak, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+// mۂL^Bowner͉ɒT߂̃L[BnameAsite͕񃊃eȂǎ̒̂n
+bool MemoryTracker::track(const void* owner, MemoryCategory category, MemoryHeap heap, uint64_t size, const char* name, const char* site)
+{
+    if (owner == nullptr)
+    {
+        return false;
+    }
+
+    // 󂫃XbgTBO񌩂ꏊ̎T̂ŁAʂ͂
+    uint32_t start = m_searchStart.load(std::memory_order_relaxed);
+    for (uint32_t n = 0; n < kMaxAllocations; ++n)
+    {
+        uint32_t index = (start + n) % kMaxAllocations;
+        Allocation& allocation = m_allocations[index];
+
+        uint32_t expected = Allocation::Free;
+        if (!allocation.state.compare_exchange_strong(expected, Allocation::Busy, std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        // õXibvVbgɎg񂵂悤ɁAgOɐi߂
+        // releasetFXŐ̍XV𒆐g݂̏KɌ悤ɂBXibvVbgacquiretFXƑ΂ɂȂ
+        allocation.generation.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        allocation.owner.store(owner, std::memory_order_relaxed);
+        allocation.name.store(name, std::memory_order_relaxed);
+        allocation.site.store(site, std::memory_order_relaxed);
+        allocation.size.store(size, std::memory_order_relaxed);
+        allocation.category.store(category, std::memory_order_relaxed);
+        allocation.heap.store(heap, std::memory_order_relaxed);
+        allocation.state.store(Allocation::Live, std::memory_order_release);
+
+        m_searchStart.store(index + 1, std::memory_order_relaxed);
+        m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        m_categoryCounters[static_cast<int>(category)].add(size);
+        m_heapCounters[static_cast<int>(heap)].add(size);
+        m_totalCounter.add(size);
+        return true;
+    }
+
+    // XbgȂBkMaxAllocations𑝂₷
+    return false;
+}
+
+// \[X̃TCYƃq[vqueryŒׂċL^
+bool MemoryTracker::trackResource(const ResourceMemoryQuery& query, const void* resource, MemoryCategory category, const char* name, const char* site)
+{
+    if (resource == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t size = 0;
+    uint32_t heapType = 0;
+    query.queryResource(resource, &size, &heapType);
+
+    return track(resource, category, heapFromD3D12HeapType(heapType), size, name, site);
+}
+
+// mۂ̋L^菜BL^ĂȂfalse
+bool MemoryTracker::untrack(const void* owner)
+{
+    if (owner == nullptr)
+    {
+        return false;
+    }
+
+    for (Allocation& allocation : m_allocations)
+    {
+        if (allocation.state.load(std::memory_order_acquire) != Allocation::Live
+            || allocation.owner.load(std::memory_order_relaxed) != owner)
+        {
+            continue;
+        }
+
+        uint32_t expected = Allocation::Live;
+        if (!allocation.state.compare_exchange_strong(expected, Allocation::Busy, std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        uint64_t size = allocation.size.load(std::memory_order_relaxed);
+        m_categoryCounters[static_cast<int>(allocation.category.load(std::memory_order_relaxed))].sub(size);
+        m_heapCounters[static_cast<int>(allocation.heap.load(std::memory_order_relaxed))].sub(size);
+        m_totalCounter.sub(size);
+        m_allocationCount.fetch_sub(1, std::memory_order_relaxed);
+
+        // Xbg͕Kオς悤ɂĂ
+        allocation.generation.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        allocation.owner.store(nullptr, std::memory_order_relaxed);
+        allocation.state.store(Allocation::Free, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+// OS擾oWFbgݒ肷
+void MemoryTracker::setBudget(MemorySegment segment, uint64_t budget, uint64_t usage)
+{
+    m_segments[static_cast<int>(segment)].budget.store(budget, std::memory_order_relaxed);
+    m_segments[static_cast<int>(segment)].usage.store(usage, std::memory_order_relaxed);
+}
+
+// ݂̋L^eLXgt@CɏoBsƂ̍₷悤ɁAmۂ͍쐬ꏊƖȌɕׁA
+// AhX⃁oWFbĝ悤Ȏsŕςl͏oȂ
+bool MemoryTracker::writeSnapshot(const char* filename) const
+{
+    struct Entry
+    {
+        const char*     name;
+        const char*     site;
+        uint64_t        size;
+        MemoryCategory  category;
+        MemoryHeap      heap;
+    };
+
+    // oɋL^ςĂ悤ɁALiveȂ̂W߂Ă
+    // ǂłԂɃXbgAėpĂ璆gĂ\̂ŁAǂݒ
+    // Ԃ厖ŁA(acquire)gacquiretFXԂƐ̊mF̏ɓǂ
+    // gɏ̒l1łĂ΁AݑreleasetFXƓāAmFŐVオ
+    std::vector<Entry> entries;
+    entries.reserve(kMaxAllocations);
+    for (const Allocation& allocation : m_allocations)
+    {
+        for (;;)
+        {
+            if (allocation.state.load(std::memory_order_acquire) != Allocation::Live)
+            {
+                break;
+            }
+            uint32_t generation = allocation.generation.load(std::memory_order_acquire);
+
+            Entry entry;
+            entry.name = allocation.name.load(std::memory_order_relaxed);
+            entry.site = allocation.site.load(std::memory_order_relaxed);
+            entry.size = allocation.size.load(std::memory_order_relaxed);
+            entry.category = allocation.category.load(std::memory_order_relaxed);
+            entry.heap = allocation.heap.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (allocation.state.load(std::memory_order_relaxed) == Allocation::Live
+                && allocation.generation.load(std::memory_order_relaxed) == generation)
+            {
+                entries.push_back(entry);
+                break;
+            }
+        }
+    }
+
+    auto safeString = [](const char* s) { return s != nullptr ? s : ""; };
+    std::sort(entries.begin(), entries.end(), [&](const Entry& a, const Entry& b)
+    {
+        int cmp = strcmp(safeString(a.site), safeString(b.site));
+        if (cmp != 0)
+        {
+            return cmp < 0;
+        }
+        cmp = strcmp(safeString(a.name), safeString(b.name));
+        if (cmp != 0)
+        {
+            return cmp < 0;
+        }
+        return a.size < b.size;
+    });
+
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "[total]\n";
+    file << "current " << totalBytes() << "\n";
+    file << "peak " << totalPeakBytes() << "\n";
+    file << "allocations " << allocationCount() << "\n";
+
+    file << "\n[category] current peak\n";
+    for (int i = 0; i < static_cast<int>(MemoryCategory::Count); ++i)
+    {
+        MemoryCategory category = static_cast<MemoryCategory>(i);
+        file << categoryName(category) << " " << currentBytes(category) << " " << peakBytes(category) << "\n";
+    }
+
+    file << "\n[heap] current peak\n";
+    for (int i = 0; i < static_cast<int>(MemoryHeap::Count); ++i)
+    {
+        MemoryHeap heap = static_cast<MemoryHeap>(i);
+        file << heapName(heap) << " " << currentBytes(heap) << " " << peakBytes(heap) << "\n";
+    }
+
+    file << "\n[allocations] site category heap size name\n";
+    for (const Entry& entry : entries)
+    {
+        file << safeString(entry.site) << " "
+            << categoryName(entry.category) << " "
+            << heapName(entry.heap) << " "
+            << entry.size << " "
+            << safeString(entry.name) << "\n";
+    }
+
+    return file.good();
+}
+
+// pr̕\
+const char* MemoryTracker::categoryName(MemoryCategory category)
+{
+    switch (category)
+    {
+    case MemoryCategory::Geometry: return "Geometry";
+    case MemoryCategory::ObjectData: return "ObjectData";
+    case MemoryCategory::RenderTarget: return "RenderTarget";
+    case MemoryCategory::DescriptorHeap: return "DescriptorHeap";
+    case MemoryCategory::ShaderBytecode: return "ShaderBytecode";
+    default: return "Unknown";
+    }
+}
+
+// q[v̕\
+const char* MemoryTracker::heapName(MemoryHeap heap)
+{
+    switch (heap)
+    {
+    case MemoryHeap::Default: return "Default";
+    case MemoryHeap::Upload: return "Upload";
+    case MemoryHeap::Readback: return "Readback";
+    case MemoryHeap::Custom: return "Custom";
+    case MemoryHeap::System: return "System";
+    default: return "Unknown";
+    }
+}
+
+// D3D12_HEAP_TYPE̒lq[v̎ނɕϊBȂl̓ftHgq[v
+MemoryHeap MemoryTracker::heapFromD3D12HeapType(uint32_t heapType)
+{
+    switch (heapType)
+    {
+    case 2: return MemoryHeap::Upload;      // D3D12_HEAP_TYPE_UPLOAD
+    case 3: return MemoryHeap::Readback;    // D3D12_HEAP_TYPE_READBACK
+    case 4: return MemoryHeap::Custom;      // D3D12_HEAP_TYPE_CUSTOM
+    default: return MemoryHeap::Default;
+    }
+}
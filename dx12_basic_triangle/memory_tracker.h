@@ -0,0 +1,135 @@
+
+// memory_tracker.h
+// gpʂ̋L^Bmۂ\[XނƂɐāAől⃁oWFbgƈꏏɌ悤ɂ
+// DirectXɂ͈ˑȂ̂ŁAfoCXł
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// mۂ̗pr
+enum class MemoryCategory : uint8_t
+{
+	Geometry,			// _obt@Ȃ
+	ObjectData,			// IuWFNgf[^̍\obt@
+	RenderTarget,		// _[^[Qbg
+	DescriptorHeap,		// fXNv^q[v
+	ShaderBytecode,		// VF[_oCi(CPU)
+	Count
+};
+
+// mۂ̃q[vBD3D12_HEAP_TYPECPU𑫂
+enum class MemoryHeap : uint8_t
+{
+	Default,
+	Upload,
+	Readback,
+	Custom,
+	System,				// GPU\[Xł͂ȂCPU
+	Count
+};
+
+// rfĨZOgBDXGI_MEMORY_SEGMENT_GROUPƓ
+enum class MemorySegment : uint8_t
+{
+	Local,				// GPU[J(prfI)
+	NonLocal,			// VXe
+	Count
+};
+
+// \[X̃𒲂ׂC^[tFCXBAvłD3D12̃foCXŁAeXgł͍lŎ
+class ResourceMemoryQuery
+{
+public:
+	virtual ~ResourceMemoryQuery() = default;
+
+	// ۂɊmۂTCYƁAD3D12_HEAP_TYPEƓl̃q[v̎ނԂBq[vȂheapType0
+	virtual void queryResource(const void* resource, uint64_t* sizeInBytes, uint32_t* heapType) const = 0;
+};
+
+// mۂ̋L^
+// L^ƉAJE^̍XV̓bNȂ̂ŁAǂ̃XbhĂł
+class MemoryTracker
+{
+public:
+	// ɋL^łmۂ̐
+	static constexpr int kMaxAllocations = 256;
+
+	// mۂL^Bowner͉ɒT߂̃L[BnameAsite͕񃊃eȂǎ̒̂n
+	bool track(const void* owner, MemoryCategory category, MemoryHeap heap, uint64_t size, const char* name, const char* site);
+
+	// \[X̃TCYƃq[vqueryŒׂċL^
+	bool trackResource(const ResourceMemoryQuery& query, const void* resource, MemoryCategory category, const char* name, const char* site);
+
+	// mۂ̋L^菜BL^ĂȂfalse
+	bool untrack(const void* owner);
+
+	// OS擾oWFbgݒ肷
+	void setBudget(MemorySegment segment, uint64_t budget, uint64_t usage);
+
+	uint64_t currentBytes(MemoryCategory category) const	{ return m_categoryCounters[static_cast<int>(category)].current.load(std::memory_order_relaxed); }
+	uint64_t peakBytes(MemoryCategory category) const		{ return m_categoryCounters[static_cast<int>(category)].peak.load(std::memory_order_relaxed); }
+	uint64_t currentBytes(MemoryHeap heap) const			{ return m_heapCounters[static_cast<int>(heap)].current.load(std::memory_order_relaxed); }
+	uint64_t peakBytes(MemoryHeap heap) const				{ return m_heapCounters[static_cast<int>(heap)].peak.load(std::memory_order_relaxed); }
+	uint64_t totalBytes() const								{ return m_totalCounter.current.load(std::memory_order_relaxed); }
+	uint64_t totalPeakBytes() const							{ return m_totalCounter.peak.load(std::memory_order_relaxed); }
+	uint32_t allocationCount() const						{ return m_allocationCount.load(std::memory_order_relaxed); }
+
+	uint64_t budget(MemorySegment segment) const			{ return m_segments[static_cast<int>(segment)].budget.load(std::memory_order_relaxed); }
+	uint64_t budgetUsage(MemorySegment segment) const		{ return m_segments[static_cast<int>(segment)].usage.load(std::memory_order_relaxed); }
+	bool isOverBudget(MemorySegment segment) const			{ return budget(segment) != 0 && budgetUsage(segment) > budget(segment); }
+
+	// ݂̋L^eLXgt@CɏoBsƂ̍₷悤ɁAmۂ͍쐬ꏊƖȌɕׁA
+	// AhX⃁oWFbĝ悤Ȏsŕςl͏oȂ
+	bool writeSnapshot(const char* filename) const;
+
+	static const char* categoryName(MemoryCategory category);
+	static const char* heapName(MemoryHeap heap);
+	static MemoryHeap heapFromD3D12HeapType(uint32_t heapType);
+
+private:
+	// ݒlƍől
+	struct Counter
+	{
+		std::atomic<uint64_t> current{ 0 };
+		std::atomic<uint64_t> peak{ 0 };
+
+		void add(uint64_t size);
+		void sub(uint64_t size) { current.fetch_sub(size, std::memory_order_relaxed); }
+	};
+
+	// m1̋L^BstateLive̊ԂgL
+	// Xbg͎g񂳂̂ŁAǂޑgenerationǂޑOŕςĂȂƂm߂
+	// ͋L^Ɖ̂тgenerationi߁AreleasetFXł璆gԂ
+	struct Allocation
+	{
+		enum State : uint32_t { Free, Busy, Live };
+
+		std::atomic<uint32_t>		state{ Free };
+		std::atomic<uint32_t>		generation{ 0 };
+		std::atomic<const void*>	owner{ nullptr };
+		std::atomic<const char*>	name{ nullptr };
+		std::atomic<const char*>	site{ nullptr };
+		std::atomic<uint64_t>		size{ 0 };
+		std::atomic<MemoryCategory>	category{ MemoryCategory::Count };
+		std::atomic<MemoryHeap>		heap{ MemoryHeap::Count };
+	};
+
+	struct Segment
+	{
+		std::atomic<uint64_t> budget{ 0 };
+		std::atomic<uint64_t> usage{ 0 };
+	};
+
+	Allocation				m_allocations[kMaxAllocations];
+	std::atomic<uint32_t>	m_searchStart{ 0 };
+	std::atomic<uint32_t>	m_allocationCount{ 0 };
+
+	Counter					m_categoryCounters[static_cast<int>(MemoryCategory::Count)];
+	Counter					m_heapCounters[static_cast<int>(MemoryHeap::Count)];
+	Counter					m_totalCounter;
+
+	Segment					m_segments[static_cast<int>(MemorySegment::Count)];
+};
@@ -0,0 +1,158 @@
+
+// adapter_selector_test.cpp
+// A_v^ĨeXgBCheckFeatureSupporťʂ̑ɍA_v^g
+
+#include "./test.h"
+
+#include "../dx12_basic_triangle/adapter_selector.h"
+
+namespace {
+    constexpr uint64_t kMegabyte = 1024ull * 1024;
+    constexpr uint32_t kFeatureLevel11_1 = 0xb100;
+    constexpr uint32_t kFeatureLevel12_0 = 0xc000;
+    constexpr uint32_t kFeatureLevel12_2 = 0xc200;
+
+    // @\SGPUBprfI128MBȂ
+    AdapterCapabilities MakeIntegratedGpu()
+    {
+        AdapterCapabilities capabilities;
+        capabilities.dedicatedVideoMemory = 128 * kMegabyte;
+        capabilities.featureLevel = kFeatureLevel12_2;
+        capabilities.shaderModel = 0x67;
+        capabilities.resourceBindingTier = 3;
+        capabilities.meshShaderTier = 1;
+        capabilities.enhancedBarriers = true;
+        return capabilities;
+    }
+
+    // @\͍Œ̊OtGPU
+    AdapterCapabilities MakeDiscreteGpu()
+    {
+        AdapterCapabilities capabilities;
+        capabilities.dedicatedVideoMemory = 2048 * kMegabyte;
+        capabilities.featureLevel = kFeatureLevel12_0;
+        capabilities.shaderModel = 0x51;
+        capabilities.resourceBindingTier = 2;
+        return capabilities;
+    }
+
+    AdapterCapabilities MakeWarp()
+    {
+        AdapterCapabilities capabilities;
+        capabilities.isSoftware = true;
+        capabilities.featureLevel = kFeatureLevel12_2;
+        capabilities.shaderModel = 0x66;
+        capabilities.resourceBindingTier = 3;
+        return capabilities;
+    }
+
+    void TestDiscreteBeatsIntegrated()
+    {
+        // 񋓏Ɋ֌WȂAprfȊOtGPUI
+        AdapterCapabilities adapters[] = { MakeIntegratedGpu(), MakeDiscreteGpu() };
+        CHECK(ScoreAdapter(adapters[1]) > ScoreAdapter(adapters[0]));
+        CHECK(SelectAdapter(adapters, 2) == 1);
+
+        AdapterCapabilities reversed[] = { MakeDiscreteGpu(), MakeIntegratedGpu() };
+        CHECK(SelectAdapter(reversed, 2) == 0);
+    }
+
+    void TestFeaturesBreakTiesWithinMemoryStep()
+    {
+        // prfI؂Ȃ@\̑
+        AdapterCapabilities basic = MakeDiscreteGpu();
+        AdapterCapabilities featured = MakeDiscreteGpu();
+        featured.dedicatedVideoMemory += 64 * kMegabyte;
+        featured.meshShaderTier = 1;
+
+        AdapterCapabilities adapters[] = { basic, featured };
+        CHECK(SelectAdapter(adapters, 2) == 1);
+
+        // 1؂ł΁A@\SĂĂ
+        AdapterCapabilities integrated = MakeIntegratedGpu();
+        AdapterCapabilities plain = MakeIntegratedGpu();
+        plain.dedicatedVideoMemory = 256 * kMegabyte;
+        plain.featureLevel = kFeatureLevel12_0;
+        plain.shaderModel = 0x51;
+        plain.resourceBindingTier = 1;
+        plain.meshShaderTier = 0;
+        plain.enhancedBarriers = false;
+        CHECK(ScoreAdapter(plain) > ScoreAdapter(integrated));
+    }
+
+    void TestSoftwareAdapterIsLastResort()
+    {
+        AdapterCapabilities warp = MakeWarp();
+        CHECK(ScoreAdapter(warp) > 0);
+
+        // n[hEFAA_v^΁AprfIĂI
+        AdapterCapabilities hardware = MakeDiscreteGpu();
+        hardware.dedicatedVideoMemory = 0;
+        CHECK(ScoreAdapter(hardware) > ScoreAdapter(warp));
+
+        AdapterCapabilities adapters[] = { warp, hardware };
+        CHECK(SelectAdapter(adapters, 2) == 1);
+
+        // WARPłWARPI
+        CHECK(SelectAdapter(&warp, 1) == 0);
+    }
+
+    void TestFeatureLevelCutoff()
+    {
+        AdapterCapabilities old = MakeDiscreteGpu();
+        old.featureLevel = kFeatureLevel11_1;
+        CHECK(ScoreAdapter(old) < 0);
+
+        AdapterCapabilities oldWarp = MakeWarp();
+        oldWarp.featureLevel = kFeatureLevel11_1;
+        CHECK(ScoreAdapter(oldWarp) < 0);
+
+        AdapterCapabilities minimum = MakeDiscreteGpu();
+        minimum.featureLevel = kFeatureLevel12_0;
+        CHECK(ScoreAdapter(minimum) > 0);
+
+        // ĝ-1
+        AdapterCapabilities adapters[] = { old, oldWarp };
+        CHECK(SelectAdapter(adapters, 2) == -1);
+        CHECK(SelectAdapter(nullptr, 0) == -1);
+    }
+
+    void TestTieKeepsEnumerationOrder()
+    {
+        // _Ȃ獂\ɗ񋓂ꂽ̕
+        AdapterCapabilities adapters[] = { MakeDiscreteGpu(), MakeDiscreteGpu(), MakeDiscreteGpu() };
+        adapters[0].deviceId = 1;
+        adapters[1].deviceId = 2;
+        adapters[2].deviceId = 3;
+        CHECK(SelectAdapter(adapters, 3) == 0);
+
+        AdapterCapabilities mixed[] = { MakeIntegratedGpu(), MakeDiscreteGpu(), MakeDiscreteGpu() };
+        CHECK(SelectAdapter(mixed, 3) == 1);
+    }
+
+    void TestSelectRenderPath()
+    {
+        CHECK(SelectRenderPath(MakeDiscreteGpu()) == RenderPath::VertexShader);
+        CHECK(SelectRenderPath(MakeIntegratedGpu()) == RenderPath::VertexShader);
+        CHECK(IsRenderPathSupported(RenderPath::VertexShader, MakeWarp()));
+
+        AdapterCapabilities old = MakeDiscreteGpu();
+        old.featureLevel = kFeatureLevel11_1;
+        CHECK(!IsRenderPathSupported(RenderPath::VertexShader, old));
+        CHECK(SelectRenderPath(old) == RenderPath::Count);
+
+        CHECK(!IsRenderPathSupported(RenderPath::Count, MakeDiscreteGpu()));
+        CHECK(RenderPathName(RenderPath::Count)[0] != '\0');
+    }
+}
+
+int main()
+{
+    test::run("DiscreteBeatsIntegrated", TestDiscreteBeatsIntegrated);
+    test::run("FeaturesBreakTiesWithinMemoryStep", TestFeaturesBreakTiesWithinMemoryStep);
+    test::run("SoftwareAdapterIsLastResort", TestSoftwareAdapterIsLastResort);
+    test::run("FeatureLevelCutoff", TestFeatureLevelCutoff);
+    test::run("TieKeepsEnumerationOrder", TestTieKeepsEnumerationOrder);
+    test::run("SelectRenderPath", TestSelectRenderPath);
+    return test::result();
+}
@@ -0,0 +1,72 @@
+
+// draw_list_benchmark.cpp
+// 100`敪̃\[gƋlߒ̑xvAWo͂ɏo
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../dx12_basic_triangle/draw_list.h"
+
+int main()
+{
+    constexpr size_t kDrawCount = 1000000;
+    constexpr int kIterationCount = 10;
+
+    // pCvC64ށA}eA1024ނ_Ɋ蓖Ă
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<uint32_t> pipelineDist(0, 63);
+    std::uniform_int_distribution<uint32_t> materialDist(0, 1023);
+
+    ObjectData objectData = {};
+    for (int i = 0; i < 4; ++i)
+    {
+        objectData.objToProj[i][i] = 1.0f;
+    }
+
+    DrawList drawList;
+    drawList.reserve(kDrawCount);
+    std::vector<ObjectData> dest(kDrawCount);
+
+    double sortSeconds = 0.0;
+    double packSeconds = 0.0;
+    size_t unsortedCount = 0;
+    for (int iteration = 0; iteration < kIterationCount; ++iteration)
+    {
+        drawList.clear();
+        for (size_t i = 0; i < kDrawCount; ++i)
+        {
+            drawList.add(pipelineDist(random), materialDist(random), objectData);
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        drawList.sort();
+        auto t1 = std::chrono::steady_clock::now();
+        drawList.pack(dest.data(), dest.size());
+        auto t2 = std::chrono::steady_clock::now();
+
+        sortSeconds += std::chrono::duration<double>(t1 - t0).count();
+        packSeconds += std::chrono::duration<double>(t2 - t1).count();
+
+        // assertReleaseŏ̂ŁAя̌͐Čʂƈꏏɏo
+        for (size_t i = 1; i < kDrawCount; ++i)
+        {
+            if (drawList[i - 1].sortKey > drawList[i].sortKey)
+            {
+                ++unsortedCount;
+            }
+        }
+    }
+
+    sortSeconds /= kIterationCount;
+    packSeconds /= kIterationCount;
+
+    printf("DrawList benchmark: %zu draws, sort %.3f ms (%.1f Mdraws/s), pack %.3f ms (%.1f Mdraws/s), %s (%zu out-of-order pairs)\n",
+        kDrawCount,
+        sortSeconds * 1000.0, kDrawCount / sortSeconds / 1000000.0,
+        packSeconds * 1000.0, kDrawCount / packSeconds / 1000000.0,
+        unsortedCount == 0 ? "OK" : "FAILED", unsortedCount);
+
+    return unsortedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+
+// draw_list_test.cpp
+// `惊Xg̃eXgB\[gƈ萫AIuWFNgf[^̋lߒm߂
+
+#include "./test.h"
+
+#include <vector>
+
+#include "../dx12_basic_triangle/draw_list.h"
+
+namespace {
+    // ǉԂ悤ɁAs̐擪ɔԍĂ
+    ObjectData MakeObjectData(uint32_t id)
+    {
+        ObjectData objectData = {};
+        objectData.objToProj[0][0] = static_cast<float>(id);
+        return objectData;
+    }
+
+    bool IsSorted(const DrawList& drawList)
+    {
+        for (size_t i = 1; i < drawList.size(); ++i)
+        {
+            if (drawList[i - 1].sortKey > drawList[i].sortKey)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TestSortByPipelineHighBits()
+    {
+        // pCvC̍ŏbitႤ́B}eȂ召Ɋ֌WȂpCvCɂȂ
+        DrawList drawList;
+        drawList.add(0x80000000u, 0, MakeObjectData(0));
+        drawList.add(0x00000000u, 0xffffffffu, MakeObjectData(1));
+        drawList.add(0x80000000u, 0xffffffffu, MakeObjectData(2));
+        drawList.add(0x00000000u, 0, MakeObjectData(3));
+        drawList.sort();
+
+        CHECK(IsSorted(drawList));
+        CHECK(drawList[0].sourceIndex == 3);
+        CHECK(drawList[1].sourceIndex == 1);
+        CHECK(drawList[2].sourceIndex == 0);
+        CHECK(drawList[3].sourceIndex == 2);
+        CHECK(DrawList::pipelineFromKey(drawList[3].sortKey) == 0x80000000u);
+        CHECK(DrawList::materialFromKey(drawList[3].sortKey) == 0xffffffffu);
+    }
+
+    void TestSortByMaterialLowBits()
+    {
+        // pCvCŁA}eẢbitႤ
+        DrawList drawList;
+        drawList.add(7, 0x101, MakeObjectData(0));
+        drawList.add(7, 0x001, MakeObjectData(1));
+        drawList.add(7, 0x100, MakeObjectData(2));
+        drawList.add(7, 0x000, MakeObjectData(3));
+        drawList.add(7, 0x0ff, MakeObjectData(4));
+        drawList.sort();
+
+        CHECK(IsSorted(drawList));
+        const uint32_t expected[] = { 3, 1, 4, 2, 0 };
+        for (size_t i = 0; i < 5; ++i)
+        {
+            CHECK(drawList[i].sourceIndex == expected[i]);
+        }
+    }
+
+    void TestSortIsStable()
+    {
+        // L[̕`͒ǉԂ̂܂ܕ
+        DrawList drawList;
+        const uint32_t pipelines[] = { 2, 1, 2, 0, 1, 2, 0, 1 };
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            drawList.add(pipelines[i], 0x12345, MakeObjectData(i));
+        }
+        drawList.sort();
+
+        CHECK(IsSorted(drawList));
+        const uint32_t expected[] = { 3, 6, 1, 4, 7, 0, 2, 5 };
+        for (size_t i = 0; i < 8; ++i)
+        {
+            CHECK(drawList[i].sourceIndex == expected[i]);
+        }
+    }
+
+    void TestSortSkipsUniformPasses()
+    {
+        // ŉʂ8bitȂ̂1pXבւBʂ͍Ɨpobt@ɂł̂œւKv
+        DrawList onePass;
+        onePass.add(5, 0xabcd03, MakeObjectData(0));
+        onePass.add(5, 0xabcd01, MakeObjectData(1));
+        onePass.add(5, 0xabcd03, MakeObjectData(2));
+        onePass.add(5, 0xabcd02, MakeObjectData(3));
+        onePass.sort();
+
+        CHECK(IsSorted(onePass));
+        const uint32_t expectedOnePass[] = { 1, 3, 0, 2 };
+        for (size_t i = 0; i < 4; ++i)
+        {
+            CHECK(onePass[i].sourceIndex == expectedOnePass[i]);
+        }
+
+        // 2pXȂ猋ʂ͌̃obt@ɖ߂
+        DrawList twoPass;
+        twoPass.add(1, 2, MakeObjectData(0));
+        twoPass.add(0, 2, MakeObjectData(1));
+        twoPass.add(1, 1, MakeObjectData(2));
+        twoPass.add(0, 1, MakeObjectData(3));
+        twoPass.sort();
+
+        CHECK(IsSorted(twoPass));
+        const uint32_t expectedTwoPass[] = { 3, 1, 2, 0 };
+        for (size_t i = 0; i < 4; ++i)
+        {
+            CHECK(twoPass[i].sourceIndex == expectedTwoPass[i]);
+        }
+
+        // SL[Ȃ1pXבւAԂ͕ςȂ
+        DrawList uniform;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            uniform.add(9, 9, MakeObjectData(i));
+        }
+        uniform.sort();
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            CHECK(uniform[i].sourceIndex == i);
+        }
+    }
+
+    void TestPackInSortedOrder()
+    {
+        DrawList drawList;
+        drawList.add(2, 0, MakeObjectData(0));
+        drawList.add(0, 0, MakeObjectData(1));
+        drawList.add(1, 0, MakeObjectData(2));
+        drawList.sort();
+
+        ObjectData dest[3] = {};
+        CHECK(drawList.pack(dest, 3) == 3);
+        CHECK(dest[0].objToProj[0][0] == 1.0f);
+        CHECK(dest[1].objToProj[0][0] == 2.0f);
+        CHECK(dest[2].objToProj[0][0] == 0.0f);
+    }
+
+    void TestPackClampsToCapacity()
+    {
+        DrawList drawList;
+        for (uint32_t i = 0; i < 6; ++i)
+        {
+            drawList.add(5 - i, 0, MakeObjectData(i));
+        }
+        drawList.sort();
+
+        // eʂ𒴂镪͏܂A񂾐Ԃ
+        std::vector<ObjectData> dest(6, MakeObjectData(100));
+        CHECK(drawList.pack(dest.data(), 4) == 4);
+        CHECK(dest[0].objToProj[0][0] == 5.0f);
+        CHECK(dest[1].objToProj[0][0] == 4.0f);
+        CHECK(dest[2].objToProj[0][0] == 3.0f);
+        CHECK(dest[3].objToProj[0][0] == 2.0f);
+        CHECK(dest[4].objToProj[0][0] == 100.0f);
+        CHECK(dest[5].objToProj[0][0] == 100.0f);
+
+        CHECK(drawList.pack(dest.data(), 0) == 0);
+
+        // `悪eʂ菭ȂΕ`搔
+        CHECK(drawList.pack(dest.data(), 10) == 6);
+    }
+}
+
+int main()
+{
+    test::run("SortByPipelineHighBits", TestSortByPipelineHighBits);
+    test::run("SortByMaterialLowBits", TestSortByMaterialLowBits);
+    test::run("SortIsStable", TestSortIsStable);
+    test::run("SortSkipsUniformPasses", TestSortSkipsUniformPasses);
+    test::run("PackInSortedOrder", TestPackInSortedOrder);
+    test::run("PackClampsToCapacity", TestPackClampsToCapacity);
+    return test::result();
+}
@@ -0,0 +1,265 @@
+
+// memory_tracker_test.cpp
+// MemoryTracker̃eXgBD3D12̃foCX̑ɍlԂResourceMemoryQueryg
+
+#include "./test.h"
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../dx12_basic_triangle/memory_tracker.h"
+
+namespace {
+    // D3D12̃foCX̑Bo^\[X̃TCYƃq[vԂ
+    class MockResourceMemoryQuery : public ResourceMemoryQuery
+    {
+    public:
+        struct Resource
+        {
+            uint64_t size;
+            uint32_t heapType;
+        };
+
+        void queryResource(const void* resource, uint64_t* sizeInBytes, uint32_t* heapType) const override
+        {
+            const Resource* mockResource = static_cast<const Resource*>(resource);
+            *sizeInBytes = mockResource->size;
+            *heapType = mockResource->heapType;
+        }
+    };
+
+    // XibvVbg[allocations]ȍ~̍sǂ
+    std::vector<std::string> ReadSnapshotAllocations(const char* filename)
+    {
+        std::vector<std::string> lines;
+        std::ifstream file(filename);
+        std::string line;
+        bool inAllocations = false;
+        while (std::getline(file, line))
+        {
+            if (inAllocations)
+            {
+                lines.push_back(line);
+            }
+            else if (line.compare(0, 13, "[allocations]") == 0)
+            {
+                inAllocations = true;
+            }
+        }
+        return lines;
+    }
+
+    void TestTrackAndUntrack()
+    {
+        MemoryTracker tracker;
+        int a = 0;
+        int b = 0;
+
+        CHECK(tracker.track(&a, MemoryCategory::Geometry, MemoryHeap::Upload, 100, "A", "site"));
+        CHECK(tracker.track(&b, MemoryCategory::RenderTarget, MemoryHeap::Default, 1000, "B", "site"));
+        CHECK(tracker.allocationCount() == 2);
+        CHECK(tracker.totalBytes() == 1100);
+        CHECK(tracker.currentBytes(MemoryCategory::Geometry) == 100);
+        CHECK(tracker.currentBytes(MemoryHeap::Default) == 1000);
+
+        CHECK(tracker.untrack(&a));
+        CHECK(!tracker.untrack(&a));
+        CHECK(!tracker.untrack(nullptr));
+        CHECK(!tracker.track(nullptr, MemoryCategory::Geometry, MemoryHeap::Upload, 1, "null", "site"));
+        CHECK(tracker.allocationCount() == 1);
+        CHECK(tracker.currentBytes(MemoryCategory::Geometry) == 0);
+        CHECK(tracker.currentBytes(MemoryHeap::Upload) == 0);
+        CHECK(tracker.totalBytes() == 1000);
+
+        CHECK(tracker.untrack(&b));
+        CHECK(tracker.allocationCount() == 0);
+        CHECK(tracker.totalBytes() == 0);
+    }
+
+    void TestPeak()
+    {
+        MemoryTracker tracker;
+        int a = 0;
+        int b = 0;
+        int c = 0;
+
+        tracker.track(&a, MemoryCategory::ObjectData, MemoryHeap::Upload, 100, "A", "site");
+        tracker.track(&b, MemoryCategory::ObjectData, MemoryHeap::Upload, 200, "B", "site");
+        tracker.untrack(&a);
+        tracker.track(&c, MemoryCategory::ObjectData, MemoryHeap::Upload, 50, "C", "site");
+
+        CHECK(tracker.currentBytes(MemoryCategory::ObjectData) == 250);
+        CHECK(tracker.peakBytes(MemoryCategory::ObjectData) == 300);
+        CHECK(tracker.peakBytes(MemoryHeap::Upload) == 300);
+        CHECK(tracker.totalPeakBytes() == 300);
+        CHECK(tracker.peakBytes(MemoryCategory::Geometry) == 0);
+    }
+
+    void TestSlotsExhausted()
+    {
+        MemoryTracker tracker;
+        static char owners[MemoryTracker::kMaxAllocations + 1];
+
+        for (int i = 0; i < MemoryTracker::kMaxAllocations; ++i)
+        {
+            CHECK(tracker.track(&owners[i], MemoryCategory::Geometry, MemoryHeap::Default, 1, "x", "site"));
+        }
+        CHECK(!tracker.track(&owners[MemoryTracker::kMaxAllocations], MemoryCategory::Geometry, MemoryHeap::Default, 1, "x", "site"));
+        CHECK(tracker.allocationCount() == static_cast<uint32_t>(MemoryTracker::kMaxAllocations));
+
+        // 󂢂Xbg͍ėp
+        CHECK(tracker.untrack(&owners[10]));
+        CHECK(tracker.track(&owners[MemoryTracker::kMaxAllocations], MemoryCategory::Geometry, MemoryHeap::Default, 1, "x", "site"));
+    }
+
+    void TestBudget()
+    {
+        MemoryTracker tracker;
+
+        // 擾O͒ĂȂ
+        CHECK(!tracker.isOverBudget(MemorySegment::Local));
+
+        tracker.setBudget(MemorySegment::Local, 1000, 500);
+        CHECK(tracker.budget(MemorySegment::Local) == 1000);
+        CHECK(tracker.budgetUsage(MemorySegment::Local) == 500);
+        CHECK(!tracker.isOverBudget(MemorySegment::Local));
+
+        tracker.setBudget(MemorySegment::Local, 1000, 1500);
+        CHECK(tracker.isOverBudget(MemorySegment::Local));
+        CHECK(!tracker.isOverBudget(MemorySegment::NonLocal));
+    }
+
+    void TestTrackResourceWithMockQuery()
+    {
+        MemoryTracker tracker;
+        MockResourceMemoryQuery query;
+
+        MockResourceMemoryQuery::Resource uploadBuffer = { 65536, 2 };		// D3D12_HEAP_TYPE_UPLOAD
+        MockResourceMemoryQuery::Resource readbackBuffer = { 4096, 3 };		// D3D12_HEAP_TYPE_READBACK
+        MockResourceMemoryQuery::Resource swapChainBuffer = { 3686400, 0 };	// q[vvpeBȂ
+
+        CHECK(tracker.trackResource(query, &uploadBuffer, MemoryCategory::ObjectData, "Upload", "site"));
+        CHECK(tracker.trackResource(query, &readbackBuffer, MemoryCategory::Geometry, "Readback", "site"));
+        CHECK(tracker.trackResource(query, &swapChainBuffer, MemoryCategory::RenderTarget, "SwapChain", "site"));
+        CHECK(!tracker.trackResource(query, nullptr, MemoryCategory::Geometry, "null", "site"));
+
+        CHECK(tracker.currentBytes(MemoryHeap::Upload) == 65536);
+        CHECK(tracker.currentBytes(MemoryHeap::Readback) == 4096);
+        CHECK(tracker.currentBytes(MemoryHeap::Default) == 3686400);
+        CHECK(tracker.currentBytes(MemoryCategory::RenderTarget) == 3686400);
+
+        CHECK(MemoryTracker::heapFromD3D12HeapType(1) == MemoryHeap::Default);
+        CHECK(MemoryTracker::heapFromD3D12HeapType(4) == MemoryHeap::Custom);
+        CHECK(MemoryTracker::heapFromD3D12HeapType(99) == MemoryHeap::Default);
+    }
+
+    void TestSnapshotOrder()
+    {
+        MemoryTracker tracker;
+        int a = 0;
+        int b = 0;
+        int c = 0;
+
+        // L^ԂXbg̈ʒuɊ֌WȂA쐬ꏊƖȌɕ
+        tracker.track(&a, MemoryCategory::ShaderBytecode, MemoryHeap::System, 10, "VertexShader", "initShaders");
+        tracker.track(&b, MemoryCategory::RenderTarget, MemoryHeap::Default, 20, "SwapChainBuffer", "initSwapChain");
+        tracker.track(&c, MemoryCategory::ShaderBytecode, MemoryHeap::System, 30, "PixelShader", "initShaders");
+        tracker.setBudget(MemorySegment::Local, 123456789, 98765);
+
+        const char* filename = "memory_tracker_test_snapshot.txt";
+        CHECK(tracker.writeSnapshot(filename));
+
+        std::vector<std::string> lines = ReadSnapshotAllocations(filename);
+        CHECK(lines.size() == 3);
+        if (lines.size() == 3)
+        {
+            CHECK(lines[0] == "initShaders ShaderBytecode System 30 PixelShader");
+            CHECK(lines[1] == "initShaders ShaderBytecode System 10 VertexShader");
+            CHECK(lines[2] == "initSwapChain RenderTarget Default 20 SwapChainBuffer");
+        }
+
+        // sŕς郁oWFbg͏oȂ
+        std::ifstream file(filename);
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        CHECK(content.find("123456789") == std::string::npos);
+        CHECK(content.find("budget") == std::string::npos);
+    }
+
+    void TestConcurrentTrackAndUntrack()
+    {
+        constexpr int kThreadCount = 8;
+        constexpr int kKeysPerThread = 16;
+        constexpr int kIterationCount = 2000;
+        constexpr uint64_t kSize = 16;
+
+        static MemoryTracker tracker;
+        static char keys[kThreadCount][kKeysPerThread];
+        std::atomic<int> misses{ 0 };
+        std::atomic<bool> done{ false };
+
+        // L^ςĂԂɃXibvVbgoĂȂ
+        std::thread snapshotThread([&]()
+        {
+            while (!done.load())
+            {
+                tracker.writeSnapshot("memory_tracker_test_concurrent.txt");
+            }
+        });
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                for (int iteration = 0; iteration < kIterationCount; ++iteration)
+                {
+                    for (int k = 0; k < kKeysPerThread; ++k)
+                    {
+                        if (!tracker.track(&keys[t][k], MemoryCategory::ObjectData, MemoryHeap::Upload, kSize, "key", "thread"))
+                        {
+                            ++misses;
+                        }
+                    }
+                    for (int k = 0; k < kKeysPerThread; ++k)
+                    {
+                        if (!tracker.untrack(&keys[t][k]))
+                        {
+                            ++misses;
+                        }
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        done.store(true);
+        snapshotThread.join();
+
+        CHECK(misses.load() == 0);
+        CHECK(tracker.allocationCount() == 0);
+        CHECK(tracker.totalBytes() == 0);
+        CHECK(tracker.peakBytes(MemoryCategory::ObjectData) <= kThreadCount * kKeysPerThread * kSize);
+        CHECK(tracker.peakBytes(MemoryCategory::ObjectData) >= kKeysPerThread * kSize);
+
+        // S̃XibvVbgɂ͊mۂ1
+        CHECK(tracker.writeSnapshot("memory_tracker_test_concurrent.txt"));
+        CHECK(ReadSnapshotAllocations("memory_tracker_test_concurrent.txt").empty());
+    }
+}
+
+int main()
+{
+    test::run("TrackAndUntrack", TestTrackAndUntrack);
+    test::run("Peak", TestPeak);
+    test::run("SlotsExhausted", TestSlotsExhausted);
+    test::run("Budget", TestBudget);
+    test::run("TrackResourceWithMockQuery", TestTrackResourceWithMockQuery);
+    test::run("SnapshotOrder", TestSnapshotOrder);
+    test::run("ConcurrentTrackAndUntrack", TestConcurrentTrackAndUntrack);
+    return test::result();
+}
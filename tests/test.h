@@ -0,0 +1,33 @@
+
+// test.h
+// eXgp̍ŏ̎dg݁BassertƈReleasełȂ
+
+#pragma once
+
+#include <cstdio>
+
+namespace test {
+    inline int& failureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // eXg1sČʂ\
+    inline void run(const char* name, void (*function)())
+    {
+        int failuresBefore = failureCount();
+        function();
+        printf("%s %s\n", failureCount() == failuresBefore ? "[ OK ]" : "[FAIL]", name);
+    }
+
+    // SeXǧʂIR[hɂ
+    inline int result()
+    {
+        return failureCount() == 0 ? 0 : 1;
+    }
+}
+
+// 藧ȂΎsƂċL^
+#define CHECK(condition) \
+    do { if (!(condition)) { printf("%s(%d): CHECK failed: %s\n", __FILE__, __LINE__, #condition); ++test::failureCount(); } } while (0)